@@ -0,0 +1,918 @@
+#include "solitaer.h"
+
+#include <cmath>
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+using namespace std;
+
+int lengthOfBoard = 7;
+int lengthOfShortEdge = 3;
+int linelen = 50;
+int maxBeamWidth = 1 << 16;
+
+size_t outBufferSize = 1 << 16;
+string outBuffer;
+void flushOutput(){
+    cout.write(outBuffer.data(), outBuffer.size());
+    cout.flush();
+    outBuffer.clear();
+}
+void out(const string& s){
+    if (outBuffer.capacity() < outBufferSize) outBuffer.reserve(outBufferSize);
+    outBuffer += s;
+    if (outBuffer.size() >= outBufferSize) flushOutput();
+}
+void out(char c){
+    if (outBuffer.capacity() < outBufferSize) outBuffer.reserve(outBufferSize);
+    outBuffer += c;
+    if (outBuffer.size() >= outBufferSize) flushOutput();
+}
+void out(int n){ out(to_string(n)); }
+void out(long n){ out(to_string(n)); }
+
+Slot::Slot(int _index, int emptyslot){
+    //@param emptyslot: index of slot that is left empty at init of board
+    index = _index;
+    occupied = (index != emptyslot) && (index >= 0);
+}
+Slot::Slot(){  // need default constructor
+    index = -1;
+    occupied = false;
+}
+int Slot::neighboringIndex(string dir, int shift){
+    // get index of neighboring slot
+    //@param dir:       string defining direction (up, down, left, right)
+    //@param shift:     size of step
+    //@param return:    SlotIndex of neighboring slot, or -1 if no slot
+    int i = (int)floor(index / lengthOfBoard);  // row
+    int j = (int)floor(index % lengthOfBoard);  // column
+
+    if (dir.compare("up")==0) i = i-shift;
+    if (dir.compare("down")==0) i = i+shift;
+    if (dir.compare("left")==0) j = j-shift;
+    if (dir.compare("right")==0) j = j+shift;
+
+    if (i >= 0 && j >= 0 && i < lengthOfBoard && j < lengthOfBoard)
+        return i*lengthOfBoard + j;
+    return -1;
+}
+void Slot::changeState(){
+    if (index > -1)
+        occupied = !occupied;
+}
+
+Board::Board(){
+    if (DEBUG) out("\ninitializing Board...");
+    numSquare = lengthOfBoard*lengthOfBoard;
+    emptyslot = numSquare/2;  // only true for odd lengthOfBoard
+    initSquareboard();
+    initSlots();
+    initEdges();
+    initSymmetries();
+    if (DEBUG) plotBoard();
+}
+void Board::initSquareboard(){
+    squareboard = new int[numSquare];
+    for (int i=0; i<numSquare; i++) squareboard[i] = i;
+    clearCorners();
+    if (DEBUG) printSquareboard();
+}
+void Board::clearCorners(){
+    // corners have no slots since x-shaped board
+    // -> set all entries of squareboard to -1 if corner
+    int numDeletedElements = lengthOfBoard - lengthOfShortEdge;
+    int deleteLeft = numDeletedElements/2;  // automatic floor
+    int deleteRight = lengthOfBoard - (numDeletedElements - deleteLeft) -1;
+    numSlots = numSquare;
+    for (int i=0; i<lengthOfBoard; i++){
+        for (int j=0; j<lengthOfBoard; j++){
+            bool cond = false;
+            cond += (i<deleteLeft && j<deleteLeft);
+            cond += (i<deleteLeft && j>deleteRight);
+            cond += (i>deleteRight && j<deleteLeft);
+            cond += (i>deleteRight && j>deleteRight);
+            if(cond){
+                squareboard[i*lengthOfBoard+j] = -1;
+                numSlots--;
+            }
+        }
+    }
+}
+void Board::initSlots(){
+    // initialize slots
+    slots = new Slot[numSquare];
+    for(int i=0; i<numSquare; i++)
+        slots[i] = Slot(squareboard[i], emptyslot);
+    numPins = numSlots-1;  // since one slot is empty on init
+}
+void Board::initEdges(){
+    // need edges for sanity check later (detectProblem)
+    edges = new int[4*lengthOfShortEdge];
+    int edgeind = 0;
+    for(int j=0; j<lengthOfBoard; j++)  // top edge
+        if(squareboard[j]>=0)
+            edges[edgeind++] = j;
+    for(int j=0; j<lengthOfBoard; j++)  // bottom edge
+        if (squareboard[(lengthOfBoard-1)*lengthOfBoard + j]>=0)
+            edges[edgeind++] = (lengthOfBoard-1)*lengthOfBoard + j;
+    for(int i=0; i<lengthOfBoard; i++)  // left edge
+        if (squareboard[i*lengthOfBoard]>=0)
+            edges[edgeind++] = i*lengthOfBoard;
+    for(int i=1; i<lengthOfBoard+1; i++)  // right edge
+        if (squareboard[i*lengthOfBoard-1]>=0)
+            edges[edgeind++] = i*lengthOfBoard-1;
+}
+void Board::initSymmetries(){
+    // rotations and mirrorings of the square, kept if they map all slots onto slots
+    // (needed for canonical keys -> symmetric board-states are equivalent)
+    // -> transformation of a key is looked up bytewise (too slow bit by bit for solve)
+    // -> keys only fit up to 64 slots, larger boards have no symmetries (and no keys)
+    numKeyBytes = (numSquare+7)/8;
+    symmetries = new unsigned long long[8*numKeyBytes*256];
+    memset(symmetries, 0, 8*numKeyBytes*256*sizeof(unsigned long long));
+    numSymmetries = 0;
+    int n = lengthOfBoard-1;
+    int* target = new int[numSquare];  // target index of every index on squareboard
+    for(int s=0; s<8 && numSquare<=64; s++){
+        bool valid = true;
+        for(int index=0; index<numSquare; index++){
+            int i = index/lengthOfBoard, j = index%lengthOfBoard;
+            if (s & 1) { int t = i; i = j; j = t; }  // transpose
+            if (s & 2) i = n-i;  // mirror vertically
+            if (s & 4) j = n-j;  // mirror horizontally
+            target[index] = i*lengthOfBoard + j;
+            if ((squareboard[index] < 0) != (squareboard[target[index]] < 0)) valid = false;
+        }
+        if (!valid) continue;
+        unsigned long long* table = &symmetries[numSymmetries*numKeyBytes*256];
+        for(int index=0; index<numSquare; index++)
+            for(int byte=0; byte<256; byte++)
+                if (byte & (1 << (index%8)))
+                    table[(index/8)*256 + byte] |= 1ULL << target[index];
+        numSymmetries++;
+    }
+    delete[] target;
+}
+bool Board::slotExists(int index){
+    if (index < 0 || index >= numSquare) return false;
+    return squareboard[index] >= 0;
+}
+void Board::setPins(const unsigned char* occupied){
+    //@param occupied: for each index on squareboard, nonzero if there is a pin (corners are ignored)
+    numPins = 0;
+    for(int i=0; i<numSquare; i++){
+        if (squareboard[i] < 0) continue;
+        slots[i].occupied = occupied[i] != 0;
+        if (slots[i].occupied) numPins++;
+    }
+}
+void Board::getPins(unsigned char* occupied){
+    for(int i=0; i<numSquare; i++)
+        occupied[i] = slots[i].occupied ? 1 : 0;
+}
+unsigned long long Board::getKey(){
+    unsigned long long key = 0;
+    for(int i=0; i<numSquare; i++)
+        if (slots[i].occupied) key |= 1ULL << i;
+    return key;
+}
+unsigned long long Board::transformKey(int symmetry, unsigned long long key){
+    //@param symmetry: 0 ... numSymmetries-1 (0 is identity)
+    unsigned long long* table = &symmetries[symmetry*numKeyBytes*256];
+    unsigned long long symKey = 0;
+    for(int b=0; b<numKeyBytes; b++)
+        symKey |= table[b*256 + ((key >> (8*b)) & 0xFF)];
+    return symKey;
+}
+unsigned long long Board::getCanonicalKey(unsigned int symmetryMask){
+    //@param symmetryMask: bit s set if symmetry s is used (e.g. only those that keep a target hole)
+    unsigned long long key = getKey();
+    unsigned long long minKey = key;
+    for(int s=1; s<numSymmetries; s++){
+        if (!((symmetryMask >> s) & 1)) continue;
+        unsigned long long symKey = transformKey(s, key);
+        if (symKey < minKey) minKey = symKey;
+    }
+    return minKey;
+}
+int Board::getPositionClass(){
+    // position class after de Bruijn: holes are colored along both diagonals in 3 colors
+    // -> a move toggles one hole of each color, so parities of the color counts change together
+    int count[2][3] = {{0, 0, 0}, {0, 0, 0}};
+    for(int index=0; index<numSquare; index++){
+        if (!slots[index].occupied) continue;
+        int i = index/lengthOfBoard, j = index%lengthOfBoard;
+        count[0][(i+j)%3]++;
+        count[1][(i-j+3*lengthOfBoard)%3]++;
+    }
+    int positionClass = 0;
+    for(int d=0; d<2; d++){
+        positionClass |= ((count[d][0]+count[d][1]) & 1) << (2*d);
+        positionClass |= ((count[d][1]+count[d][2]) & 1) << (2*d+1);
+    }
+    return positionClass;
+}
+void Board::printSquareboard(){
+    out("\n\nSQUAREBOARD:\n");
+    for (int i=0; i<numSquare; i++){
+        if (squareboard[i] == -1) out("   ");
+        else{
+            if(squareboard[i] < 10) out(' ');
+            out(' ');
+            out(squareboard[i]);
+        }
+        if ((i+1)%lengthOfBoard == 0) out('\n');
+    }
+}
+void Board::plotBoard(){
+    out("\n\nCURRENT BOARD:\n");
+    for (int i=0; i<numSquare; i++){
+        out(' ');
+        if (squareboard[i] < 0) out(' ');
+        else out(slots[squareboard[i]].occupied ? 'O' : '-');
+        if ((i+1)%lengthOfBoard == 0) out('\n');
+    }
+}
+Board::~Board(){
+    delete[] squareboard;
+    delete[] slots;
+    delete[] edges;
+    delete[] symmetries;
+}
+
+Move::Move(Board& board, int _reference, bool _dir){
+    dir = _dir;
+    reference = _reference;
+    string dirstr = dir ? "right" : "down";
+    middle = board.slots[reference].neighboringIndex(dirstr, 1);
+    far = board.slots[reference].neighboringIndex(dirstr, 2);
+    exists = board.slotExists(middle) && board.slotExists(far);
+    if (dir) exists = exists && (reference/lengthOfBoard == far/lengthOfBoard);  // exclude line wrapping
+}
+Move::Move(){
+    dir = false;
+    reference = -1;
+    middle = -1;
+    far = -1;
+    exists = false;
+}
+bool Move::isPossible(Board& board){
+    if (!exists) return false;
+    return board.slots[middle].occupied && (board.slots[reference].occupied != board.slots[far].occupied);
+}
+bool Move::doMove(Board& board){
+    if (!isPossible(board)) return false;
+    board.slots[reference].changeState();
+    board.slots[middle].changeState();
+    board.slots[far].changeState();
+    return true;
+}
+bool Move::isPossibleUndo(Board& board){
+    if (!exists) return false;
+    return !board.slots[middle].occupied && (board.slots[reference].occupied != board.slots[far].occupied);
+}
+bool Move::undoMove(Board& board){
+    if (!isPossibleUndo(board)) return false;
+    board.slots[reference].changeState();
+    board.slots[middle].changeState();
+    board.slots[far].changeState();
+    return true;
+}
+void printSpace(int n){
+    if (n > 0) out(string(n, ' '));
+}
+void Move::plotMove(Board &board){
+    out("\n \nEXECUTED MOVE: ");
+    printSpace(3*lengthOfBoard-15);
+    out("RESULTING BOARD:\n");
+    for (int i=0; i<lengthOfBoard; i++){
+        // move
+        for (int j=0; j<lengthOfBoard; j++){
+            out(' ');
+            int slotind = i*lengthOfBoard+j;
+            if (board.squareboard[slotind] < 0) out(' ');
+            else{
+                if ((slotind==reference) || (slotind==middle) || (slotind==far))
+                    out(board.slots[board.squareboard[slotind]].occupied ? 'x' : 'X');
+                else
+                    out(board.slots[board.squareboard[slotind]].occupied ? 'O' : '-');
+            }
+        }
+        // space
+        printSpace(lengthOfBoard);
+        // resulting board
+        for (int j=0; j<lengthOfBoard; j++){
+            out(' ');
+            int slotind = i*lengthOfBoard+j;
+            if (board.squareboard[slotind] < 0) out(' ');
+            else out(board.slots[board.squareboard[slotind]].occupied ? 'O' : '-');
+        }
+        out('\n');
+    }
+}
+
+Target::Target(int _numPins, int _hole){
+    numPins = _numPins;
+    hole = _hole;
+    // hole outside of the squareboard: no final board-state, isReached is never true
+    if (numPins == 1 && hole >= 0 && hole < lengthOfBoard*lengthOfBoard){  // final board-state is known
+        finalPins.assign(lengthOfBoard*lengthOfBoard, 0);
+        finalPins[hole] = 1;
+    }
+}
+Target::Target(Board& board, const unsigned char* _finalPins){
+    //@param _finalPins: for each index on squareboard, nonzero if there is a pin (corners are ignored)
+    numPins = 0;
+    hole = -1;
+    finalPins.assign(board.numSquare, 0);
+    for(int i=0; i<board.numSquare; i++){
+        if (!board.slotExists(i) || !_finalPins[i]) continue;
+        finalPins[i] = 1;
+        numPins++;
+        if (hole < 0) hole = i;  // any pin of the final board-state has to be occupied
+    }
+}
+bool Target::isReached(Board& board){
+    if (board.numPins > numPins) return false;
+    if (hole >= 0 && (hole >= board.numSquare || !board.slots[hole].occupied)) return false;
+    if (finalPins.empty()) return true;
+    for(int i=0; i<board.numSquare; i++)
+        if (board.slots[i].occupied != (finalPins[i] != 0)) return false;
+    return true;
+}
+bool Target::knowsFinal(){
+    return !finalPins.empty();
+}
+bool Target::operator==(const Target& other) const{
+    return numPins == other.numPins && hole == other.hole && finalPins == other.finalPins;
+}
+
+Game::Game(){
+    if (DEBUG) print("\ninitializing Game...\n");
+    if (DEBUG) print("\ninitializing Moves...\n");
+    initExistingMoves();
+    initMoveLists();
+    numIts = 0;
+    numSavedMoves = 0;
+    minNumPins = board.numPins;
+    showProgress = true;
+    startPins.resize(board.numSquare);
+    board.getPins(startPins.data());
+    preparedTarget = Target(-1);  // matches no real target
+    targetValid = false;
+    pagodaWeights = new double[board.numSquare];
+    usePagoda = false;
+    initSinglePinClasses();
+}
+void Game::initSinglePinClasses(){
+    Board singleBoard;
+    vector<unsigned char> single(board.numSquare, 0);
+    singlePinClasses = 0;
+    singlePinClass.assign(board.numSquare, -1);
+    for(int index=0; index<board.numSquare; index++){
+        if (!board.slotExists(index)) continue;
+        single[index] = 1;
+        singleBoard.setPins(single.data());
+        singlePinClass[index] = singleBoard.getPositionClass();
+        singlePinClasses |= 1 << singlePinClass[index];
+        single[index] = 0;
+    }
+}
+int Game::getPinClasses(int numPins){
+    // classes are additive (xor) -> combine single pins
+    // (pins may share a hole here, so this is a superset -> only good for ruling out)
+    int classes = 1;  // no pins: class 0
+    for(int p=0; p<numPins; p++){
+        int next = 0;
+        for(int c=0; c<16; c++)
+            if ((classes >> c) & 1)
+                for(int single=0; single<16; single++)
+                    if ((singlePinClasses >> single) & 1) next |= 1 << (c ^ single);
+        classes = next;
+    }
+    return classes;
+}
+bool Game::initSingleMove(int index, bool dir){
+    // check if a move exists and add to existingMoves if it does
+    Move newmove = Move(board, index, dir);
+    if (newmove.exists){
+        existingMoves[numExistingMoves++] = newmove;
+        return true;
+    }
+    return false;
+}
+void Game::initExistingMoves(){
+    // initialize all moves that could theoretically come up at some board-state
+    int maxNumMoves = board.numSlots * 2;  // theoretical maximum
+    numExistingMoves = 0;  // count how many they actually are
+    existingMoves = new Move[maxNumMoves];
+    for(int m=0; m<board.numSquare; m++){
+        if(board.squareboard[m] >= 0){
+            initSingleMove(m, false);
+            initSingleMove(m, true);
+        }
+    }
+    if (DEBUG){
+        out("\nNumber of existing moves: ");
+        out(numExistingMoves);
+    }
+}
+void Game::initMoveLists(){
+    // -1 for empty slot, -1 for remaining pin, +1 since undoMoves resets the entry after the last move
+    int maxNumMoves = board.numSlots-1;
+    savedMoves = new int[maxNumMoves];
+    executedMovePtrs = new int[maxNumMoves];
+    memset(executedMovePtrs, 0, maxNumMoves*sizeof(int));
+    numPossibleMoves = new int[maxNumMoves];
+    possibleMoves = new int[maxNumMoves * numExistingMoves];
+    memset(possibleMoves, -1, maxNumMoves * numExistingMoves*sizeof(int));
+}
+Game::~Game(){
+    delete[] existingMoves;
+    delete[] savedMoves;
+    delete [] possibleMoves;
+    delete [] numPossibleMoves;
+    delete [] executedMovePtrs;
+    delete [] pagodaWeights;
+}
+bool Game::doMove(int moveind){
+    //@param moveind: index of move in existingMoves
+    Move currmove = existingMoves[moveind];
+    if(!currmove.doMove(board)) return false;  // change pins
+    savedMoves[numSavedMoves++] = moveind;
+    board.numPins--;
+    if(DEBUG) currmove.plotMove(board);
+    return true;
+}
+bool Game::undoMoves(int numMoves){
+    for(int m=0; m<numMoves; m++){
+        executedMovePtrs[numSavedMoves--] = 0;  // restart at first possible move for subsequent move
+        int moveind = savedMoves[numSavedMoves];  // get index on existingMoves of executed move
+        Move currmove = existingMoves[moveind];
+        if(!currmove.undoMove(board)) return false;
+        if(DEBUG) print("undoing move");
+        if(DEBUG) currmove.plotMove(board);
+    }
+    board.numPins += numMoves;
+    return true;
+}
+int Game::getCurMoveslist(){
+    // get list of all moves that are possible at moment of call
+    // add all possible moves to possibleMoves at column for current move
+    //@return: number of possible moves
+    int numPossMoves = 0;
+    for(int m=0; m<numExistingMoves; m++){
+        if(existingMoves[m].isPossible(board)){
+            possibleMoves[numSavedMoves*numExistingMoves+numPossMoves] = m;
+            numPossMoves++;
+        }
+    }
+    numPossibleMoves[numSavedMoves] = numPossMoves;
+    executedMovePtrs[numSavedMoves] = 0;  // always start at first posMove in list (gCMl isn't called again for identical board)
+    return numPossMoves;
+}
+int Game::getMoveindFromPossibleMoves(int moveOnList){
+    // get index on existingMoves from chosen possibility on possibleMoves
+    return possibleMoves[numSavedMoves*numExistingMoves+moveOnList];
+}
+bool Game::detectProblem(){
+    // rough check if board is still solvable
+    // method: check how many "legs" (= edges) are still to be freed
+    //          -> need at least three pins in the middle for each leg to free them
+    int numLostLegs = 0;
+    int numFreePins = board.numPins;
+    for(int leg=0; leg<4; leg++){
+        bool legLost = false;
+        for(int pin=0; pin<lengthOfShortEdge; pin++){
+            int slotind = board.edges[leg*lengthOfShortEdge+pin];
+            if (board.slots[slotind].occupied){
+                legLost = true;
+                numFreePins--;
+            }
+        }
+        if (legLost) numLostLegs++;
+    }
+    return (numFreePins < numLostLegs*3) && (numLostLegs>1);
+}
+bool Game::reactToProblem(){
+    undoMoves(1);
+    while(detectProblem()) undoMoves(1);
+    return incCurMove();
+}
+bool Game::checkIfProblem(){
+    // summarize detect and solve problem
+    if (!targetPossible()){
+        if (DEBUG) print("Target not reachable");
+        return reactToProblem();
+    }
+    if (board.numPins<15)
+        if(detectProblem()) {
+            if (DEBUG) print("Problem detected");
+            return reactToProblem();
+        }
+    return true;
+}
+bool Game::resolveDeadEnd(){
+    if (board.numPins < minNumPins)  // save how good it became
+        minNumPins = board.numPins;
+    undoMoves(max(1, board.numPins/2));  // at least one, incCurMove continues after an undo
+    numIts++;
+    if(showProgress && numIts%10000 == 0) printState();
+    return incCurMove();
+}
+bool Game::initIteration(){
+    getCurMoveslist();
+    doMove(getMoveindFromPossibleMoves(0));  // do first possible move
+    return true;
+}
+bool Game::nextMove(){
+    // just do next move
+    if (target.isReached(board)) return true;
+    if (board.numPins <= target.numPins) return resolveDeadEnd();  // pins left, but not the target
+    if (getCurMoveslist()==0) return resolveDeadEnd();
+    doMove(getMoveindFromPossibleMoves(0));  // do first possible move
+    return checkIfProblem();
+}
+bool Game::incCurMove(){
+    // if a move ran into dead end or problem
+    //      -> go back to sane stage by undoing
+    //      -> do a move that wasn't done before (next on list of possible moves for last undone move)
+    if(numSavedMoves<=1) return false;  // if very first move fails -> everything fails
+    executedMovePtrs[numSavedMoves]++;  // go to next possible move
+    if (executedMovePtrs[numSavedMoves] >= numPossibleMoves[numSavedMoves]){
+        // if list of possible moves is exhausted
+        undoMoves(1);
+        return incCurMove();  // carry-over and inc previous move
+    }
+    doMove(getMoveindFromPossibleMoves(executedMovePtrs[numSavedMoves]));  // do next possile move
+    return nextMove();
+}
+bool Game::iterate(const Target& _target){
+    // main function to find solution
+    //@param _target: goal, e.g. number of pins left at the end
+    // -> heuristics here (undo several moves at a dead end, never vary the first move) only suit the
+    //    symmetric center start with a number of pins as target; everything else is solved exactly
+    time(&start);
+    Board centerBoard;
+    vector<unsigned char> centerPins(board.numSquare);
+    centerBoard.getPins(centerPins.data());
+    if (_target.hole >= 0 || centerPins != startPins || numSavedMoves > 0){
+        bool solved = solve(_target);
+        time(&finish);
+        return solved;
+    }
+    if (!initTarget(_target)) return false;
+    initIteration();
+    while(!target.isReached(board))
+        if(!nextMove()) return false;
+    time(&finish);
+    return true;
+}
+bool Game::setPosition(const unsigned char* occupied){
+    // replace board-state and forget executed moves
+    //@return: false if the position has no empty slot (nothing could ever move)
+    board.setPins(occupied);
+    board.getPins(startPins.data());
+    numSavedMoves = 0;
+    minNumPins = board.numPins;
+    return board.numPins < board.numSlots;
+}
+bool Game::setStart(int emptyHole){
+    //@param emptyHole: index on squareboard
+    if (!board.slotExists(emptyHole)) return false;
+    vector<unsigned char> occupied(board.numSquare, 1);
+    occupied[emptyHole] = 0;
+    return setPosition(occupied.data());
+}
+void Game::prepareTarget(const Target& _target){
+    // everything that only depends on the target (not on the board-state) -> only redone if target changes
+    target = _target;
+    preparedTarget = _target;
+    deadPositions.clear();
+    targetValid = target.hole < 0 || board.slotExists(target.hole);
+    if (!targetValid) return;
+    targetSymmetries = ~0u;
+    if (target.hole >= 0 && board.numSquare <= 64){  // symmetric board-states only equivalent if target is
+        unsigned long long targetKey = 1ULL << target.hole;
+        if (target.knowsFinal()){
+            targetKey = 0;
+            for(int index=0; index<board.numSquare; index++)
+                if (target.finalPins[index]) targetKey |= 1ULL << index;
+        }
+        for(int s=1; s<32; s++)
+            if (s >= board.numSymmetries || board.transformKey(s, targetKey) != targetKey)
+                targetSymmetries &= ~(1u << s);
+    }
+    usePagoda = target.hole >= 0;
+    if (usePagoda){
+        const double sigma = (sqrt(5.0)-1)/2;  // sigma^(d+2) + sigma^(d+1) = sigma^d
+        int hi = target.hole/lengthOfBoard, hj = target.hole%lengthOfBoard;
+        for(int index=0; index<board.numSquare; index++){
+            int i = index/lengthOfBoard, j = index%lengthOfBoard;
+            pagodaWeights[index] = pow(sigma, abs(i-hi) + abs(j-hj));
+        }
+        pagodaMin = 0;
+        if (target.knowsFinal()){
+            for(int index=0; index<board.numSquare; index++)
+                if (target.finalPins[index]) pagodaMin += pagodaWeights[index];
+        }
+        else pagodaMin = 1;  // at least the target hole is occupied
+        pagodaMin -= 1e-9;  // rounding
+    }
+    // position classes are additive (xor) -> class of the final board-state from its single pins
+    finalClass = 0;
+    if (target.knowsFinal()){
+        for(int index=0; index<board.numSquare; index++)
+            if (target.finalPins[index]) finalClass ^= singlePinClass[index];
+    }
+    holeClass = target.hole >= 0 ? singlePinClass[target.hole] : 0;
+    restPinClasses = getPinClasses(target.hole >= 0 ? target.numPins-1 : target.numPins);
+}
+bool Game::initTarget(const Target& _target){
+    if (!(_target == preparedTarget)) prepareTarget(_target);
+    if (!targetValid) return false;
+    if (target.knowsFinal()){  // position class can't change -> has to be the one of the target
+        if (board.getPositionClass() != finalClass) return false;
+    }
+    else if (board.numPins > target.numPins){
+        // pins left at the end need the class of the board-state; without a target hole they can be anywhere,
+        // with one the other numPins-1 pins need the class of the board-state xor the one of the target hole
+        if (!((restPinClasses >> (board.getPositionClass() ^ holeClass)) & 1)) return false;
+    }
+    return targetPossible();
+}
+double Game::getPagoda(){
+    double pagoda = 0;
+    for(int index=0; index<board.numSquare; index++)
+        if (board.slots[index].occupied) pagoda += pagodaWeights[index];
+    return pagoda;
+}
+double Game::getPagodaLoss(int moveind){
+    Move& move = existingMoves[moveind];
+    int from = board.slots[move.reference].occupied ? move.reference : move.far;
+    int to = from == move.reference ? move.far : move.reference;
+    return pagodaWeights[from] + pagodaWeights[move.middle] - pagodaWeights[to];
+}
+bool Game::targetPossible(){
+    return !usePagoda || getPagoda() >= pagodaMin;
+}
+bool Game::solve(const Target& _target){
+    // exact depth-first search, other than iterate only pruning that can't lose solutions
+    // -> board-states that failed once are remembered in deadPositions
+    //    and stay remembered for further calls with the same target
+    // -> with a target hole, moves that lose least pagoda are tried first
+    //@param _target: goal, e.g. number of pins left at the end
+    //@return: true if solution found; moves of solution are then on savedMoves
+    if (!initTarget(_target)) return false;  // clears deadPositions if target changed
+    return solveFromHere();
+}
+bool Game::solveFromHere(){
+    if (target.isReached(board)) return true;
+    if (board.numPins <= target.numPins || !targetPossible()) return false;
+    bool useKeys = board.numSquare <= 64;  // keys only fit up to 8x8 boards -> no deadPositions above
+    unsigned long long key = useKeys ? board.getCanonicalKey(targetSymmetries) : 0;
+    if (useKeys && deadPositions.count(key)) return false;
+    int* moves = &possibleMoves[numSavedMoves*numExistingMoves];  // row for current move
+    int numMoves = 0;
+    for(int m=0; m<numExistingMoves; m++)
+        if (existingMoves[m].isPossible(board)) moves[numMoves++] = m;
+    if (usePagoda)
+        sort(moves, moves+numMoves, [this](int a, int b){ return getPagodaLoss(a) < getPagodaLoss(b); });
+    for(int m=0; m<numMoves; m++){
+        doMove(moves[m]);
+        if (solveFromHere()) return true;
+        undoMoves(1);
+    }
+    if (board.numPins < minNumPins) minNumPins = board.numPins;
+    if (useKeys) deadPositions.insert(key);
+    return false;
+}
+int Game::evaluate(){
+    // pins on edges and isolated pins (no neighbor) are hard to remove later
+    int rating = 0;
+    for(int e=0; e<4*lengthOfShortEdge; e++)
+        if (board.slots[board.edges[e]].occupied) rating += 2;
+    for(int index=0; index<board.numSquare; index++){
+        if (!board.slots[index].occupied) continue;
+        int i = index/lengthOfBoard, j = index%lengthOfBoard;
+        bool isolated = true;
+        if (i > 0 && board.slots[index-lengthOfBoard].occupied) isolated = false;
+        if (i < lengthOfBoard-1 && board.slots[index+lengthOfBoard].occupied) isolated = false;
+        if (j > 0 && board.slots[index-1].occupied) isolated = false;
+        if (j < lengthOfBoard-1 && board.slots[index+1].occupied) isolated = false;
+        if (isolated) rating += 3;
+        if (target.hole >= 0)  // distance to target hole
+            rating += abs(i - target.hole/lengthOfBoard) + abs(j - target.hole%lengthOfBoard);
+    }
+    return rating;
+}
+int Game::beamRound(int beamWidth, vector<int>& bestMoves, bool& reached, bool randomize,
+                    chrono::steady_clock::time_point deadline, long maxNodes, long& numNodes){
+    // one beam search from current board-state: per depth keep the beamWidth best rated board-states
+    // -> board-states that reach the target are rated best, those that can't reach it are dropped
+    //@param bestMoves: returns moves to the deepest board-state reached (moveind on existingMoves)
+    //@param reached:   returns if the deepest board-state is the target
+    //@param randomize: break ties of rating randomly (otherwise every round with same width is identical)
+    //@param numNodes:  counts generated board-states (for maxNodes)
+    //@return:          number of pins left on the deepest board-state
+    int numSquare = board.numSquare;
+    bool useKeys = numSquare <= 64;  // keys only fit up to 8x8 boards -> no duplicate detection above
+    vector<unsigned char> start(numSquare), layer, children;
+    board.getPins(start.data());
+    int startPins = board.numPins;
+    layer = start;
+    int numLayer = 1;
+    vector< vector<int> > parents, moves;  // per depth: index of parent on previous layer, move done
+    unordered_set<unsigned long long> seen;
+    vector< pair<int, int> > ranking;  // (rating, index of child)
+    vector<int> childParents, childMoves;
+    bool budgetLeft = true;
+    while(budgetLeft){
+        children.clear();
+        childParents.clear();
+        childMoves.clear();
+        ranking.clear();
+        seen.clear();
+        for(int p=0; p<numLayer && budgetLeft; p++){
+            board.setPins(&layer[p*numSquare]);
+            for(int m=0; m<numExistingMoves; m++){
+                if (!existingMoves[m].doMove(board)) continue;
+                board.numPins--;
+                unsigned long long key = 0;
+                if (useKeys) key = board.getCanonicalKey(targetSymmetries);
+                if ((!useKeys || seen.insert(key).second) && targetPossible()){
+                    int rating = evaluate();
+                    if (randomize) rating = rating*16 + rand()%16;
+                    if (target.isReached(board)) rating = -1;
+                    ranking.push_back(make_pair(rating, (int)childParents.size()));
+                    children.resize(children.size()+numSquare);
+                    board.getPins(&children[children.size()-numSquare]);
+                    childParents.push_back(p);
+                    childMoves.push_back(m);
+                }
+                existingMoves[m].undoMove(board);
+                board.numPins++;
+                numNodes++;
+            }
+            if (maxNodes > 0 && numNodes >= maxNodes) budgetLeft = false;
+            if (chrono::steady_clock::now() >= deadline) budgetLeft = false;
+        }
+        if (!budgetLeft || ranking.empty()) break;  // only complete layers count
+        int numNext = min(beamWidth, (int)ranking.size());
+        partial_sort(ranking.begin(), ranking.begin()+numNext, ranking.end());
+        layer.resize(numNext*numSquare);
+        parents.push_back(vector<int>(numNext));
+        moves.push_back(vector<int>(numNext));
+        for(int c=0; c<numNext; c++){
+            int child = ranking[c].second;
+            memcpy(&layer[c*numSquare], &children[child*numSquare], numSquare);
+            parents.back()[c] = childParents[child];
+            moves.back()[c] = childMoves[child];
+        }
+        numLayer = numNext;
+        if (startPins - (int)moves.size() <= target.numPins) break;
+    }
+    bestMoves.resize(moves.size());  // trace back best rated board-state of deepest layer
+    int c = 0;
+    for(int d=(int)moves.size()-1; d>=0; d--){
+        bestMoves[d] = moves[d][c];
+        c = parents[d][c];
+    }
+    board.setPins(layer.data());
+    reached = target.isReached(board);
+    board.setPins(start.data());
+    return startPins - (int)moves.size();
+}
+bool Game::searchBeam(const Target& _target, double maxSeconds, long maxNodes){
+    // anytime search for boards too large for iterate/ solve
+    // -> beam searches with growing width, then restarts with random tie-breaks, until budget is used up
+    // -> best sequence so far is kept; in the end it is done on the board (savedMoves, minNumPins)
+    // -> if the target can't be reached, it still searches for the fewest pins left
+    //@param _target:    goal, e.g. number of pins left at the end (stops early if reached)
+    //@param maxSeconds: time budget (<= 0: no time limit)
+    //@param maxNodes:   budget of generated board-states (<= 0: no limit)
+    //@return:           true if target was reached
+    if (maxSeconds <= 0 && maxNodes <= 0) return false;  // would never stop
+    time(&start);
+    if (_target.hole >= 0 && !board.slotExists(_target.hole)) return false;  // target can never be reached
+    if (!initTarget(_target))  // valid, but can't be reached (class or pagoda) -> still minimize pins
+        usePagoda = false;  // no pruning by target, but evaluate still rates distance to target hole
+    // elapsed time, not CPU time (-> budget holds on a busy host)
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::time_point::max();
+    if (maxSeconds > 0)
+        deadline = chrono::steady_clock::now()
+                 + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(maxSeconds));
+    vector<int> best, current;
+    int bestNumPins = board.numPins;
+    bool bestReached = target.isReached(board), reached;
+    long numNodes = 0;
+    int beamWidth = 1;
+    numIts = 0;
+    while(!bestReached){
+        bool randomize = beamWidth >= maxBeamWidth;
+        int numPinsLeft = beamRound(beamWidth, current, reached, randomize, deadline, maxNodes, numNodes);
+        if (reached || numPinsLeft < bestNumPins){
+            bestNumPins = numPinsLeft;
+            bestReached = reached;
+            best = current;
+            if (DEBUG){
+                out("\nBeam width: ");
+                out(beamWidth);
+                out("; best result: ");
+                out(bestNumPins);
+            }
+        }
+        numIts++;
+        if (maxNodes > 0 && numNodes >= maxNodes) break;
+        if (chrono::steady_clock::now() >= deadline) break;
+        if (beamWidth < maxBeamWidth) beamWidth *= 2;
+    }
+    for(size_t m=0; m<best.size(); m++)
+        doMove(best[m]);
+    if (board.numPins < minNumPins) minNumPins = board.numPins;
+    time(&finish);
+    return bestReached;
+}
+void Game::print(string s){
+    out('\n');
+    out(s);
+}
+void printThickLine(){
+    out(" \n ");
+    out(string(linelen-2, '='));
+}
+void printInThickLines(string s){
+    int space = linelen - s.length() - 4;
+    int s1 = space/2;
+    int s2 = space -s1;
+    out("\n||");
+    printSpace(s1);
+    out(s);
+    printSpace(s2);
+    out("||");
+}
+void Game::printHeader(){
+    printThickLine();
+    printInThickLines(" ");
+    printInThickLines("Script to solve the game \"Solitaer\"");
+    printInThickLines("by Sula Mueller (12/2020)");
+    printInThickLines(" ");
+    printThickLine();
+    print(" \n");
+    flushOutput();
+}
+void Game::printState(){
+    out("\nIteration: ");
+    out(numIts);
+    out("; best result: ");
+    out(minNumPins);
+    flushOutput();  // progress is shown right away
+}
+void Game::printPlotExplanation(){
+    print(" \n ");
+    printThickLine();
+    printInThickLines(" ");
+    printInThickLines("PLOTTING RESULTING MOVES");
+    printInThickLines(" ");
+    printThickLine();
+    print("\n \n  O : slot with pin \n  - : slot without pin \n  X : pins that jump over each other \n  x : previous free slot a pin jumps into");
+    print(" \n ");
+    print("\n LEFT: move to be done     RIGHT: board after move\n");
+}
+void Game::plotAllMoves(){
+    printPlotExplanation();
+    Board showboard;
+    showboard.setPins(startPins.data());
+    for(int m=0; m<numSavedMoves; m++){
+        Move currmov = existingMoves[savedMoves[m]];
+        currmov.doMove(showboard);
+        currmov.plotMove(showboard);
+    }
+    out("\n \nNUMBER OF ITERATIONS = ");
+    out(numIts);
+    out("\nPROCESSING TIME = ");
+    out((long)(finish-start));
+    out('s');
+    flushOutput();
+}
+string Game::getSolution(){
+    // one line "from-to from-to ...", for pipelines that don't need the plotted boards
+    // -> direction of a move is only known on the board, so moves are done again from startPins
+    Board showboard;
+    showboard.setPins(startPins.data());
+    string solution;
+    solution.reserve(numSavedMoves*6);
+    for(int m=0; m<numSavedMoves; m++){
+        Move currmov = existingMoves[savedMoves[m]];
+        bool forward = showboard.slots[currmov.reference].occupied;
+        int from = forward ? currmov.reference : currmov.far;
+        int to = forward ? currmov.far : currmov.reference;
+        if (m > 0) solution += ' ';
+        solution += to_string(from) + '-' + to_string(to);
+        currmov.doMove(showboard);
+    }
+    return solution;
+}
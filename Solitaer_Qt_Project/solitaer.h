@@ -0,0 +1,198 @@
+#ifndef SOLITAER_H
+#define SOLITAER_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <chrono>
+#include <time.h>
+
+// definitions are in solitaer.cpp (-> header can be included by several translation units)
+
+extern int lengthOfBoard;
+extern int lengthOfShortEdge;
+
+// debug output is a compile-time policy (-> no branches for it in the search unless compiled in)
+#ifndef SOLITAER_DEBUG
+#define SOLITAER_DEBUG 0
+#endif
+const bool DEBUG = SOLITAER_DEBUG;
+extern int linelen;
+extern int maxBeamWidth;  // searchBeam stops widening the beam here and restarts with random tie-breaks
+
+// all output is collected in outBuffer and written in bulk (cout per character is too slow for traces)
+extern size_t outBufferSize;  // flush when buffer is this full
+extern std::string outBuffer;
+void flushOutput();
+void out(const std::string& s);
+void out(char c);
+void out(int n);
+void out(long n);
+
+class Slot{
+    // class to define a slot on the board, able to be occupied by a pin or not
+public:
+    int index;  // "name" of slot (not strictly ascending, since some positions don't have a slot)
+    bool occupied;  // by a pin
+    Slot(int, int);
+    Slot();
+    ~Slot(){};
+    int neighboringIndex(std::string dir, int shift);  // give index of neighboring slot
+    void changeState();  // switch between occupied or not
+};
+
+class Board{
+    // class to define a board with slots
+public:
+    int numSquare,  // lengthOfBoard^2 (includes empty corners)
+        numSlots,   // number of live slots (constant, excludes empty corners)
+        numPins,    // number of occupied slots (variable)
+        numSymmetries;  // number of rotations/ mirrorings that map the board onto itself
+    int* squareboard;  // indice of all slots [numSquare]; -1 if there is no slot
+    int* edges;  // list of all indice on (short) edges [4*lengthOfShortEdge]
+    Slot* slots;  // array of all slots [numSquare]
+    Board();
+    ~Board();
+    Board(const Board&) = delete;  // owns its arrays
+    Board& operator=(const Board&) = delete;
+    bool slotExists(int);  // check if there is a slot on this position of the squareboard
+    void setPins(const unsigned char* occupied);  // set board-state from array [numSquare]
+    void getPins(unsigned char* occupied);  // write board-state to array [numSquare]
+    unsigned long long getKey();  // bitmask of occupied slots (bit = index on squareboard; only numSquare <= 64)
+    unsigned long long getCanonicalKey(unsigned int symmetryMask = ~0u);  // smallest key of all symmetric board-states
+    unsigned long long transformKey(int symmetry, unsigned long long key);  // key of symmetric board-state
+    int getPositionClass();  // invariant of all moves (-> board-states of different class can't be reached)
+    void plotBoard();  // debug output
+    void printSquareboard();  // debug output
+private:
+    int emptyslot;  // initial position of empty slot
+    int numKeyBytes;  // number of bytes of a key
+    unsigned long long* symmetries;  // for each symmetry and byte of a key, transformed bits [8*numKeyBytes*256]
+    void initSquareboard();
+    void clearCorners();  // clear corners of squareboard (where there are no slots)
+    void initSlots();
+    void initEdges();
+    void initSymmetries();
+};
+
+class Move{
+    // class to define all moves that could in theory be done
+    // a move involves three slots in a row [reference, middle, far]
+    // row can be horizontal (dir = true) or vertical (dir = false)
+    //@param referenceslot: left or upper slot in a row of three slots
+    //@param dir:           horizontal -> : true / vertical v : false
+public:
+    bool dir,  // horizontal or vertical
+         exists;  // move can be done IN PRINCIPLE -> all slots are on the board (constant)
+    int reference, middle, far;  // indice of involved slots
+    Move(Board&, int _reference, bool _dir);
+    Move();
+    ~Move(){};
+    bool doMove(Board& board);  // change slots on board according to move
+    bool undoMove(Board& board);  // change slots on board like they were before a move was done
+    bool isPossible(Board& board);  // move can be done AT THE MOMENT (depends on current state of board)
+    bool isPossibleUndo(Board& board);
+    void plotMove(Board& board);
+};
+
+class Target{
+    // goal of a search: number of pins left at the end
+    // optionally: last pin on a specific hole or an exact final board-state
+public:
+    int numPins,  // number of pins left at the end
+        hole;  // index on squareboard that has to be occupied at the end (-1: any)
+    std::vector<unsigned char> finalPins;  // exact final board-state [numSquare] (empty: any)
+    Target(int _numPins = 1, int _hole = -1);
+    Target(Board& board, const unsigned char* _finalPins);
+    bool isReached(Board& board);
+    bool knowsFinal();  // final board-state is known (exact, or a single pin on hole)
+    bool operator==(const Target& other) const;
+};
+
+class Game{
+    // class to start a game, iterate through possible moves etc
+    // main class
+public:
+    int numIts,  // count failed attempts
+        minNumPins;  // remember how good best so far solution was
+    time_t start, finish;  // measure execution time
+    Board board;
+    Game();
+    ~Game();
+    Game(const Game&) = delete;  // owns its arrays
+    Game& operator=(const Game&) = delete;
+    Target target;  // goal of the current search
+    bool showProgress;  // print iteration count and best result while iterating
+    bool iterate(const Target& _target);
+    bool setPosition(const unsigned char* occupied);  // start from arbitrary board-state [numSquare]
+    bool setStart(int emptyHole);  // start with all slots occupied but emptyHole
+    bool solve(const Target& _target);  // exact search from current board-state
+    bool searchBeam(const Target& _target, double maxSeconds, long maxNodes = 0);  // anytime search with budget
+    void print(std::string);
+    void printHeader();
+    void plotAllMoves();
+    std::string getSolution();  // compact solution: moves as "from-to" holes (index on squareboard)
+
+    int numExistingMoves,  // number of moves that are theoretically possible ("existing moves")
+        numSavedMoves;  // number of executed moves
+    Move* existingMoves;  // array of all moves that are theoretically possible [numExistingMoves]
+    int* savedMoves;  // all executed moves in correct order [numSlots -1]
+    bool doMove(int moveind);  // do a specified move ("moveind" as index on existingMoves)
+    bool undoMoves(int numMoves);  // undo last numMoves moves
+private:
+    int* possibleMoves;  // all possible moves for each executed move [numExistingMoves*(numSlots-1)]
+    int* numPossibleMoves;  // for each executed move, save how many moves are possible (max of possibleMoves)
+    int* executedMovePtrs;  // for each executed move, save which move was done (ptr on list of possibleMoves)
+    std::vector<unsigned char> startPins;  // board-state before the first saved move [numSquare]
+    std::unordered_set<unsigned long long> deadPositions;  // keys of board-states that failed in solve
+    Target preparedTarget;  // target that deadPositions and all target-derived data below are valid for
+    bool targetValid;  // target hole is a slot
+    int finalClass;  // position class of the final board-state (if target knows it)
+    int holeClass;  // position class of a single pin on the target hole (0: no target hole)
+    int restPinClasses;  // getPinClasses of the pins left beside the one on the target hole
+    unsigned int targetSymmetries;  // symmetries that keep the target (-> for getCanonicalKey)
+    int singlePinClasses;  // bit c set if a board-state with a single pin can have position class c
+    std::vector<int> singlePinClass;  // position class of a single pin on every index on squareboard (-1: no slot)
+
+    // target-aware pruning: pagoda function after Conway, weight sigma^distance to target hole
+    // -> a move never increases the sum of weights of all pins, so if the sum is below the one of
+    //    the target, the target can't be reached any more
+    bool usePagoda;
+    double* pagodaWeights;  // weight of every index on squareboard [numSquare]
+    double pagodaMin;  // sum of weights at the target
+
+    bool initSingleMove(int index, bool dir);
+    void initExistingMoves();  // init array of all existing moves
+    void initMoveLists();  // init all above move lists
+    void initSinglePinClasses();
+    int getPinClasses(int numPins);  // bit c set if numPins pins can have position class c
+
+    int getCurMoveslist();  // get list of all moves that are currently possible
+    int getMoveindFromPossibleMoves(int moveOnList);  // get "moveind" from possibleMoves
+
+    bool detectProblem();  // do sanity check
+    bool reactToProblem();  // undo a few moves if check fails
+    bool checkIfProblem();  // summarize both
+    bool resolveDeadEnd();  // undo a few moves if there are no options left
+
+    void prepareTarget(const Target& _target);  // set target and everything derived from it (once per target)
+    bool initTarget(const Target& _target);  // set target and pruning; false if target can't be reached
+    double getPagoda();  // sum of pagoda weights of all pins
+    double getPagodaLoss(int moveind);  // decrease of getPagoda if move is done
+    bool targetPossible();  // false if target can't be reached from current board-state
+
+    bool solveFromHere();
+
+    int evaluate();  // cheap rating of board-state for searchBeam (lower is better)
+    int beamRound(int beamWidth, std::vector<int>& bestMoves, bool& reached, bool randomize,
+                  std::chrono::steady_clock::time_point deadline, long maxNodes, long& numNodes);
+
+    bool initIteration();
+    bool nextMove();
+    bool incCurMove();  // do next move on list of possible moves for current move
+
+    void printState();
+    void printPlotExplanation();
+};
+
+#endif // SOLITAER_H
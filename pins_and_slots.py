@@ -185,6 +185,13 @@ class Board:
         print(' ')
         print(showboard)
 
+    def getPositionArray(self) -> np.ndarray:
+        # occupation of all slots in squareboard order (input format of the solitaer extension)
+        position = np.zeros(np.square(lengthOfBoard), dtype=np.uint8)
+        for key in self.slots:
+            position[int(key)] = self.slots[key].occupied
+        return position
+
     def getNumberOfFreeSlots(self, free: bool = True) -> int:
         # count number of free or occupied slots
         # @param free:  define if free slots (True) or occupied slots are counted
@@ -0,0 +1,14 @@
+import numpy as np
+from setuptools import setup, Extension
+
+# build the "solitaer" extension next to pins_and_slots.py:
+#   python setup.py build_ext --inplace
+solitaer = Extension(
+    'solitaer',
+    sources=['solitaer_module.cpp', 'Solitaer_Qt_Project/solitaer.cpp'],
+    include_dirs=['Solitaer_Qt_Project', np.get_include()],
+    extra_compile_args=['-std=c++11', '-O2'],
+    language='c++',
+)
+
+setup(name='solitaer', version='0.1', ext_modules=[solitaer])
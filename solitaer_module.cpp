@@ -0,0 +1,246 @@
+
+// Python extension "solitaer": batch queries on the C++ engine (Solitaer_Qt_Project/solitaer.h)
+// positions are NumPy arrays [N, lengthOfBoard^2] or [N, lengthOfBoard, lengthOfBoard] (uint8 or bool)
+// -> same squareboard indexing as pins_and_slots.py: index = i*lengthOfBoard + j, nonzero = pin
+// -> C-contiguous uint8/ bool arrays are used without copying
+// build: python setup.py build_ext --inplace
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+#include "solitaer.h"
+
+static PyArrayObject* getPositions(PyObject* obj, npy_intp* numPositions){
+    // get positions as C-contiguous array of bytes (view if possible, copy otherwise)
+    //@param numPositions: returns number of positions N
+    //@return: new reference, NULL with exception set on error
+    PyArrayObject* positions = NULL;
+    if (PyArray_Check(obj) && PyArray_ISCARRAY_RO((PyArrayObject*)obj)
+        && (PyArray_TYPE((PyArrayObject*)obj) == NPY_BOOL || PyArray_TYPE((PyArrayObject*)obj) == NPY_UINT8)){
+        Py_INCREF(obj);
+        positions = (PyArrayObject*)obj;
+    }
+    else{
+        positions = (PyArrayObject*)PyArray_FROM_OTF(obj, NPY_UINT8, NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST);
+        if (positions == NULL) return NULL;
+    }
+    int ndim = PyArray_NDIM(positions);
+    npy_intp* shape = PyArray_DIMS(positions);
+    int numSquare = lengthOfBoard*lengthOfBoard;
+    bool valid = (ndim == 2 && shape[1] == numSquare)
+              || (ndim == 3 && shape[1] == lengthOfBoard && shape[2] == lengthOfBoard);
+    if (!valid){
+        PyErr_Format(PyExc_ValueError, "positions must have shape (N, %d) or (N, %d, %d)",
+                     numSquare, lengthOfBoard, lengthOfBoard);
+        Py_DECREF(positions);
+        return NULL;
+    }
+    *numPositions = shape[0];
+    return positions;
+}
+
+static PyObject* existing_moves(PyObject*, PyObject*){
+    // all moves that exist on the board: [M, 3] (reference, middle, far) as index on squareboard
+    Game g;
+    npy_intp dims[2] = {g.numExistingMoves, 3};
+    PyArrayObject* moves = (PyArrayObject*)PyArray_SimpleNew(2, dims, NPY_INT32);
+    if (moves == NULL) return NULL;
+    int* out = (int*)PyArray_DATA(moves);
+    for(int m=0; m<g.numExistingMoves; m++){
+        out[3*m] = g.existingMoves[m].reference;
+        out[3*m+1] = g.existingMoves[m].middle;
+        out[3*m+2] = g.existingMoves[m].far;
+    }
+    return (PyObject*)moves;
+}
+
+static PyObject* solvable(PyObject*, PyObject* args, PyObject* kwargs){
+    // for each position, check if it can be reduced to the target: [N] bool
+    //@param numPins: number of pins left at the end
+    //@param hole:    index on squareboard that has to be occupied at the end (-1: any)
+    //@param final:   exact final position [numSquare] (replaces numPins and hole)
+    static const char* kwlist[] = {"positions", "numPins", "hole", "final", NULL};
+    PyObject* obj;
+    PyObject* finalObj = Py_None;
+    int numPins = 1, hole = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|iiO", (char**)kwlist, &obj, &numPins, &hole, &finalObj))
+        return NULL;
+    int numSquare = lengthOfBoard*lengthOfBoard;
+    if (hole != -1){
+        Board board;
+        if (!board.slotExists(hole)){
+            PyErr_Format(PyExc_ValueError, "hole %d is not a slot on the board", hole);
+            return NULL;
+        }
+    }
+    PyArrayObject* final = NULL;
+    if (finalObj != Py_None){
+        final = (PyArrayObject*)PyArray_FROM_OTF(finalObj, NPY_UINT8, NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST);
+        if (final == NULL) return NULL;
+        if (PyArray_SIZE(final) != numSquare){
+            PyErr_Format(PyExc_ValueError, "final must have %d entries", numSquare);
+            Py_DECREF(final);
+            return NULL;
+        }
+    }
+    npy_intp numPositions;
+    PyArrayObject* positions = getPositions(obj, &numPositions);
+    if (positions == NULL){
+        Py_XDECREF(final);
+        return NULL;
+    }
+    PyArrayObject* result = (PyArrayObject*)PyArray_SimpleNew(1, &numPositions, NPY_BOOL);
+    if (result == NULL){
+        Py_DECREF(positions);
+        Py_XDECREF(final);
+        return NULL;
+    }
+    const unsigned char* in = (const unsigned char*)PyArray_DATA(positions);
+    unsigned char* out = (unsigned char*)PyArray_DATA(result);
+    Py_BEGIN_ALLOW_THREADS
+    Game g;  // dead positions are shared by the whole batch
+    Target target = final ? Target(g.board, (const unsigned char*)PyArray_DATA(final)) : Target(numPins, hole);
+    for(npy_intp n=0; n<numPositions; n++){
+        g.setPosition(&in[n*numSquare]);
+        out[n] = g.solve(target);
+    }
+    Py_END_ALLOW_THREADS
+    Py_DECREF(positions);
+    Py_XDECREF(final);
+    return (PyObject*)result;
+}
+
+static PyObject* legal_moves(PyObject*, PyObject* obj){
+    // for each position and existing move, check if move can be done: [N, M] bool
+    npy_intp numPositions;
+    PyArrayObject* positions = getPositions(obj, &numPositions);
+    if (positions == NULL) return NULL;
+    Game g;
+    npy_intp dims[2] = {numPositions, g.numExistingMoves};
+    PyArrayObject* result = (PyArrayObject*)PyArray_SimpleNew(2, dims, NPY_BOOL);
+    if (result == NULL){
+        Py_DECREF(positions);
+        return NULL;
+    }
+    const unsigned char* in = (const unsigned char*)PyArray_DATA(positions);
+    unsigned char* out = (unsigned char*)PyArray_DATA(result);
+    Py_BEGIN_ALLOW_THREADS
+    int numSquare = g.board.numSquare;
+    for(npy_intp n=0; n<numPositions; n++){
+        g.setPosition(&in[n*numSquare]);
+        for(int m=0; m<g.numExistingMoves; m++)
+            out[n*g.numExistingMoves+m] = g.existingMoves[m].isPossible(g.board);
+    }
+    Py_END_ALLOW_THREADS
+    Py_DECREF(positions);
+    return (PyObject*)result;
+}
+
+static PyObject* successors(PyObject*, PyObject* obj){
+    // all positions reachable with one move
+    //@return: (children [K, numSquare] uint8, parents [K] int64, moves [K] int32)
+    //          parents = index on positions, moves = index on existing_moves()
+    npy_intp numPositions;
+    PyArrayObject* positions = getPositions(obj, &numPositions);
+    if (positions == NULL) return NULL;
+    const unsigned char* in = (const unsigned char*)PyArray_DATA(positions);
+    Game g;
+    int numSquare = g.board.numSquare;
+
+    npy_intp numChildren = 0;  // first pass: count children to allocate results
+    Py_BEGIN_ALLOW_THREADS
+    for(npy_intp n=0; n<numPositions; n++){
+        g.setPosition(&in[n*numSquare]);
+        for(int m=0; m<g.numExistingMoves; m++)
+            if (g.existingMoves[m].isPossible(g.board)) numChildren++;
+    }
+    Py_END_ALLOW_THREADS
+
+    npy_intp dims[2] = {numChildren, numSquare};
+    PyArrayObject* children = (PyArrayObject*)PyArray_SimpleNew(2, dims, NPY_UINT8);
+    PyArrayObject* parents = (PyArrayObject*)PyArray_SimpleNew(1, &numChildren, NPY_INT64);
+    PyArrayObject* moves = (PyArrayObject*)PyArray_SimpleNew(1, &numChildren, NPY_INT32);
+    if (children == NULL || parents == NULL || moves == NULL){
+        Py_XDECREF(children);
+        Py_XDECREF(parents);
+        Py_XDECREF(moves);
+        Py_DECREF(positions);
+        return NULL;
+    }
+    unsigned char* outChildren = (unsigned char*)PyArray_DATA(children);
+    npy_int64* outParents = (npy_int64*)PyArray_DATA(parents);
+    int* outMoves = (int*)PyArray_DATA(moves);
+    Py_BEGIN_ALLOW_THREADS
+    npy_intp k = 0;
+    for(npy_intp n=0; n<numPositions; n++){
+        g.setPosition(&in[n*numSquare]);
+        for(int m=0; m<g.numExistingMoves; m++){
+            if (!g.doMove(m)) continue;
+            g.board.getPins(&outChildren[k*numSquare]);
+            outParents[k] = n;
+            outMoves[k] = m;
+            k++;
+            g.undoMoves(1);
+        }
+    }
+    Py_END_ALLOW_THREADS
+    Py_DECREF(positions);
+    return Py_BuildValue("(NNN)", children, parents, moves);
+}
+
+static PyObject* canonical_key(PyObject*, PyObject* obj){
+    // for each position, key that is identical for all symmetric positions: [N] uint64
+    if (lengthOfBoard*lengthOfBoard > 64){
+        PyErr_SetString(PyExc_ValueError, "keys only exist for boards up to 64 holes");
+        return NULL;
+    }
+    npy_intp numPositions;
+    PyArrayObject* positions = getPositions(obj, &numPositions);
+    if (positions == NULL) return NULL;
+    PyArrayObject* result = (PyArrayObject*)PyArray_SimpleNew(1, &numPositions, NPY_UINT64);
+    if (result == NULL){
+        Py_DECREF(positions);
+        return NULL;
+    }
+    const unsigned char* in = (const unsigned char*)PyArray_DATA(positions);
+    npy_uint64* out = (npy_uint64*)PyArray_DATA(result);
+    Py_BEGIN_ALLOW_THREADS
+    Board board;
+    for(npy_intp n=0; n<numPositions; n++){
+        board.setPins(&in[n*board.numSquare]);
+        out[n] = board.getCanonicalKey();
+    }
+    Py_END_ALLOW_THREADS
+    Py_DECREF(positions);
+    return (PyObject*)result;
+}
+
+static PyMethodDef solitaerMethods[] = {
+    {"existing_moves", existing_moves, METH_NOARGS,
+     "existing_moves() -> int32 [M, 3]: (reference, middle, far) of every existing move"},
+    {"solvable", (PyCFunction)(void(*)(void))solvable, METH_VARARGS | METH_KEYWORDS,
+     "solvable(positions, numPins=1, hole=-1, final=None) -> bool [N]: position can reach the target"},
+    {"legal_moves", legal_moves, METH_O,
+     "legal_moves(positions) -> bool [N, M]: existing move can be done on position"},
+    {"successors", successors, METH_O,
+     "successors(positions) -> (children uint8 [K, S], parents int64 [K], moves int32 [K])"},
+    {"canonical_key", canonical_key, METH_O,
+     "canonical_key(positions) -> uint64 [N]: occupation bitmask, minimal over symmetries"},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef solitaerModule = {
+    PyModuleDef_HEAD_INIT, "solitaer",
+    "Fast batch queries on Solitaer positions (C++ engine).", -1, solitaerMethods
+};
+
+PyMODINIT_FUNC PyInit_solitaer(void){
+    import_array();
+    PyObject* module = PyModule_Create(&solitaerModule);
+    if (module == NULL) return NULL;
+    PyModule_AddIntConstant(module, "lengthOfBoard", lengthOfBoard);
+    PyModule_AddIntConstant(module, "lengthOfShortEdge", lengthOfShortEdge);
+    return module;
+}